@@ -7,51 +7,106 @@
 
 #include <SFML/Graphics.hpp>
 #include <cmath>                //  for trig/geometry/linear functions
+#include <algorithm>
 #include "breakout_defs.h"
+#include "breakout_physics.h"
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
 
 using namespace std::chrono;
 
+// Drawing resources (windowed runs only)
+// --------------------------------------------------------
+
+const int WALL_QUADS = 4; // walls come before the bricks in the board vertices
+
+// shapes and board vertices, filled in by createBoardMesh() on the first frame drawn
+struct BoardMesh {
+    bool created;
+    sf::VertexArray vertices; // walls then bricks, four corners each
+    sf::VertexBuffer buffer;  // GPU copy of vertices, when the driver supports it
+    bool useBuffer;
+    sf::RectangleShape paddle;
+    sf::CircleShape ball;
+};
+
 // Function declarations
 // --------------------------------------------------------
 
-void setup(Ball &refBall, Borders &refBorder, MovingBlock &refPaddle, Brick bricks[BRICK_ROWS][BRICK_COLUMNS]);
+void setup(BallSet &refBalls, Borders &refBorder, MovingBlock &refPaddle, Brick bricks[BRICK_ROWS][BRICK_COLUMNS],
+           GameStats &refStats);
+void serveBalls(BallSet &balls, MovingBlock &paddle);
+void launchBalls(BallSet &balls, float delta);
 Direction processInput() ;
 
-bool update(Direction &input, Ball &ball, float delta, Borders walls,
-            MovingBlock &paddle, bool &started, Brick bricks[BRICK_ROWS][BRICK_COLUMNS]);
-
-void render(sf::RenderWindow &window, Ball &ball, float delta, Borders walls, MovingBlock paddle,
-            Brick bricks[BRICK_ROWS][BRICK_COLUMNS]);
+bool update(Direction &input, BallSet &balls, float delta, Borders walls,
+            MovingBlock &paddle, bool &started, Brick bricks[BRICK_ROWS][BRICK_COLUMNS], GameStats &stats);
 
-int getCollisionPoint(Ball *pBall, Block *pBlock);
-bool checkBlockCollision(Block moving, Block stationary);
-bool collisionCheck(Ball *pBall, Block *pBlock);
-bool doCollisionChecks (Ball &ball, MovingBlock &paddle, Borders walls, Brick bricks[BRICK_ROWS][BRICK_COLUMNS]);
+void render(sf::RenderWindow &window, BoardMesh &mesh, BallSet &balls, float delta, Borders walls,
+            MovingBlock paddle, Brick bricks[BRICK_ROWS][BRICK_COLUMNS]);
+void createBoardMesh(BoardMesh &mesh, Borders &walls, Brick bricks[BRICK_ROWS][BRICK_COLUMNS]);
+void setQuad(sf::Vertex *pQuad, const Block &block);
 
 //-----------------------------------------------------------
 
 
 /**
  * The main application
+ * @param argc - number of command line arguments
+ * @param argv - command line arguments (--balls N serves N balls per life,
+ *               --headless runs without a window for at most --frames N frames)
  * @return OS status message (0=Success)
  */
-int main() {
+int main(int argc, char *argv[]) {
 
-    // render a 2d graphics window
-    sf::RenderWindow window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Break Out!");
-    window.clear(WINDOW_COLOR);
+    // tracks how long startup takes
+    auto launch = high_resolution_clock::now();
 
     // declarations
     Borders walls;
-    Ball theBall;
+    BallSet balls;
     MovingBlock paddle;
     Brick bricks[BRICK_ROWS][BRICK_COLUMNS];
+    GameStats stats;
+
+    // command line options
+    balls.launchCount = 1;
+    bool headless = false;
+    int maxFrames = HEADLESS_FRAMES;
+    for (int arg = 1; arg < argc; arg++)
+    {
+        if (strcmp(argv[arg], "--balls") == 0 && arg + 1 < argc)
+        {
+            balls.launchCount = std::clamp(atoi(argv[++arg]), 1, MAX_BALLS);
+        }
+        else if (strcmp(argv[arg], "--frames") == 0 && arg + 1 < argc)
+        {
+            maxFrames = std::max(atoi(argv[++arg]), 1);
+        }
+        else if (strcmp(argv[arg], "--headless") == 0)
+        {
+            headless = true;
+        }
+    }
 
     // set up the game components
     // ------------------------------------------------
-    setup(theBall, walls, paddle, bricks);
+    setup(balls, walls, paddle, bricks, stats);
+
+    // render a 2d graphics window (drawing resources are made on the first frame).
+    // Headless runs make no window or mesh, so they never open a display or GL context.
+    std::unique_ptr<sf::RenderWindow> window;
+    std::unique_ptr<BoardMesh> mesh;
+    if (!headless)
+    {
+        window = std::make_unique<sf::RenderWindow>(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Break Out!");
+        window->clear(WINDOW_COLOR);
+        mesh = std::make_unique<BoardMesh>();
+        mesh->created = false;
+    }
 
     // time variables for the main game loop
     sf::Clock clock;
@@ -65,41 +120,65 @@ int main() {
     bool started = false;
     bool gameOver = false;
     bool pauseGame;
+    bool startupReported = false;
+    int frames = 0;
     while (!gameOver)
     {
-        // calculates the frame time
-        stopTime = clock.getElapsedTime();
-        delta += (stopTime.asMilliseconds() - startTime.asMilliseconds());
-        startTime = stopTime;
+        Direction userInput = Start; // headless runs serve the ball straight away
+
+        if (headless)
+        {
+            // fixed frame time, no window events or keyboard
+            delta = FRAME_RATE;
+        }
+        else
+        {
+            // calculates the frame time
+            stopTime = clock.getElapsedTime();
+            delta += (stopTime.asMilliseconds() - startTime.asMilliseconds());
+            startTime = stopTime;
 
-        // process events
-        sf::Event event;
-        while (!gameOver && window.pollEvent(event)) {
+            // process events
+            sf::Event event;
+            while (!gameOver && window->pollEvent(event)) {
 
-            if (event.type == sf::Event::Closed) //  closes the window
+                if (event.type == sf::Event::Closed) //  closes the window
+                    gameOver = true;
+            }
+
+            // Process user input
+            // ------------------------------------------------
+            userInput = processInput();
+            if (userInput == Exit)
                 gameOver = true;
         }
 
-        // Process user input
-        // ------------------------------------------------
-        Direction userInput = processInput();
-        if (userInput == Exit)
-            gameOver = true;
-
         // Process Updates
         // ------------------------------------------------
         if (delta >= FRAME_RATE) {
 
-            gameOver = update(userInput, theBall, delta, walls, paddle, started, bricks);
+            gameOver = update(userInput, balls, delta, walls, paddle, started, bricks, stats);
 
             // subtract the frame-rate from the current frame-time for each full frame covered by this update
             while (delta >= FRAME_RATE)
                 delta -= FRAME_RATE;
+
+            if (headless && ++frames >= maxFrames)
+                gameOver = true;
         }
 
         // Render the window
         // ------------------------------------------------
-        render(window, theBall, delta, walls, paddle, bricks);
+        if (!headless)
+            render(*window, *mesh, balls, delta, walls, paddle, bricks);
+
+        // startup ends once the first frame is done (drawn, including its lazily made mesh, or simulated)
+        if (!startupReported)
+        {
+            auto ready = high_resolution_clock::now();
+            std::cout<<"\nStartup: "<< duration<double, std::milli>(ready - launch).count()<< " ms\n";
+            startupReported = true;
+        }
 
     } // end main game loop
 
@@ -111,9 +190,11 @@ int main() {
 
     std::cout<<"\nTime Elapsed: "<< timeElapsed.count()<< " seconds\n";
     std::cout<<"\nReset ball "<< restartCount<< " times.\n";
+    std::cout<<"\nScore: "<< stats.score<< " (" << stats.lives << " lives left)\n";
 
     // close graphics window
-    window.close();
+    if (window)
+        window->close();
 
     return 0;
 } // end main
@@ -121,12 +202,14 @@ int main() {
 
 /**
  * Initializes game window and blocks
- * @param refBall = rendered ball
+ * @param refBalls = rendered balls (launchCount must already be set)
  * @param refBorder = reference to borders to render
  * @param refPaddle = reference to paddle to render
  * @param bricks = array of bricks to render
+ * @param refStats = reference to score and lives to reset
  */
-void setup(Ball &refBall, Borders &refBorder, MovingBlock &refPaddle, Brick bricks[BRICK_ROWS][BRICK_COLUMNS]){
+void setup(BallSet &refBalls, Borders &refBorder, MovingBlock &refPaddle, Brick bricks[BRICK_ROWS][BRICK_COLUMNS],
+           GameStats &refStats){
 
     // paddle
     refPaddle.block.left = (WINDOW_WIDTH - PADDLE_WIDTH) / 2.0;
@@ -134,121 +217,94 @@ void setup(Ball &refBall, Borders &refBorder, MovingBlock &refPaddle, Brick bric
     refPaddle.block.width = PADDLE_WIDTH;
     refPaddle.block.height = PADDLE_THICKNESS;
     refPaddle.block.color = PADDLE_COLOR;
-    refPaddle.block.rectangle.setSize(sf::Vector2(PADDLE_WIDTH, PADDLE_THICKNESS));
-    refPaddle.block.rectangle.setFillColor(PADDLE_COLOR);
     refPaddle.velocityX = 0.0;
     refPaddle.velocityY = 0.0;
 
 
-    // walls
+    // walls, from the precomputed board layout
     //------------------------------------------------------
-    // left border
-    refBorder.leftBlock.left = 0.0;
-    refBorder.leftBlock.top = 0.0;
-    refBorder.leftBlock.width = WALL_THICKNESS;
-    refBorder.leftBlock.height = WINDOW_HEIGHT;
-    refBorder.leftBlock.rectangle.setSize(sf::Vector2(refBorder.leftBlock.width,refBorder.leftBlock.height));
-    refBorder.leftBlock.rectangle.setPosition(refBorder.leftBlock.left, refBorder.leftBlock.top);
-    refBorder.leftBlock.rectangle.setFillColor(WALL_COLOR);
-
-    // top border
-    refBorder.topBlock.left = 0.0;
-    refBorder.topBlock.top = 0.0;
-    refBorder.topBlock.width = WINDOW_WIDTH;
-    refBorder.topBlock.height = WALL_THICKNESS;
-    refBorder.topBlock.rectangle.setSize(sf::Vector2(refBorder.topBlock.width,refBorder.topBlock.height));
-    refBorder.topBlock.rectangle.setPosition(refBorder.topBlock.left, refBorder.topBlock.top);
-    refBorder.topBlock.rectangle.setFillColor(WALL_COLOR);
-
-    // right border
-    refBorder.rightBlock.left = WINDOW_WIDTH - WALL_THICKNESS;
-    refBorder.rightBlock.top = 0.0;
-    refBorder.rightBlock.width = WALL_THICKNESS;
-    refBorder.rightBlock.height = WINDOW_HEIGHT;
-    refBorder.rightBlock.rectangle.setSize(sf::Vector2(refBorder.rightBlock.width,refBorder.rightBlock.height));
-    refBorder.rightBlock.rectangle.setPosition(refBorder.rightBlock.left, refBorder.rightBlock.top);
-    refBorder.rightBlock.rectangle.setFillColor(WALL_COLOR);
-
-    // bottom border
-    refBorder.bottomBlock.left = 0.0;
-    refBorder.bottomBlock.top = WINDOW_HEIGHT - WALL_THICKNESS;
-    refBorder.bottomBlock.width = WINDOW_WIDTH;
-    refBorder.bottomBlock.height = WALL_THICKNESS;
-    refBorder.bottomBlock.rectangle.setSize(sf::Vector2(refBorder.bottomBlock.width,refBorder.bottomBlock.height));
-    refBorder.bottomBlock.rectangle.setPosition(refBorder.bottomBlock.left, refBorder.bottomBlock.top);
-    refBorder.bottomBlock.rectangle.setFillColor(WALL_COLOR);
+    refBorder.leftBlock = makeBlock(BOARD_LAYOUT.leftWall, WALL_COLOR);
+    refBorder.topBlock = makeBlock(BOARD_LAYOUT.topWall, WALL_COLOR);
+    refBorder.rightBlock = makeBlock(BOARD_LAYOUT.rightWall, WALL_COLOR);
+    refBorder.bottomBlock = makeBlock(BOARD_LAYOUT.bottomWall, WALL_COLOR);
     //--------------------------------------------------------
     // end of borders
 
 
-    // the ball
-    refBall.radius = BALL_RADIUS;
-    refBall.coordinateX = refPaddle.block.left + (PADDLE_WIDTH / 2.0);
-    refBall.coordinateY = refPaddle.block.top - BALL_RADIUS - 1;
-    refBall.velocityX = 0.0;
-    refBall.velocityY = 0.0;
-    refBall.color = BALL_COLOR;
+    // the balls
+    serveBalls(refBalls, refPaddle);
+
 
+    // score and lives
+    refStats.score = 0;
+    refStats.lives = START_LIVES;
+    refStats.bricksLeft = BRICK_ROWS * BRICK_COLUMNS;
 
-    // Bricks setup
-    float bricksTop = FIRST_BRICK; // start at lowest brick row
 
+    // Bricks setup, from the precomputed board layout
     Brick *pNextBrick = &bricks[0][0]; // pointer to first brick
+    const BlockGeometry *pGeometry = &BOARD_LAYOUT.bricks[0][0];
 
     for (int row = 0; row < BRICK_ROWS; row++)  // for ROWS
     {
-
-        float bricksLeft = BRICKS_LEFT; // far left bricks
-
         for (int column = 0; column < BRICK_COLUMNS; column++)  // for COLUMNS
         {
+            // row properties come from the brick type table
+            pNextBrick->type = BRICK_ROW_TYPES[row];
+            pNextBrick->hitsLeft = BRICK_BEHAVIORS[pNextBrick->type].hits;
+            pNextBrick->block = makeBlock(*pGeometry, BRICK_BEHAVIORS[pNextBrick->type].color);
 
-            // offset left and top add by 1
-            pNextBrick->block.left = bricksLeft + 1;
-            pNextBrick->block.top = bricksTop + 1;
+            pNextBrick->hit = false;
+            pNextBrick++;
+            pGeometry++;
+        } // brick columns
+    } // brick rows
+}
 
-            //subtract 2 from width & height for the space for 1-pixel
-            pNextBrick->block.width = BRICK_WIDTH - 2;
-            pNextBrick->block.height = BRICK_HEIGHT - 2;
 
-            // row properties
-            if (row < 2)
-            {
-                pNextBrick->block.color = sf::Color::White;
-                pNextBrick->points = 1;
-                pNextBrick-> speedAdjust = 0;
-            }
-            else if (row < 4)
-            {
-                pNextBrick->block.color = sf::Color(112, 121, 121); // Light Grey
-                pNextBrick->points = 4;
-                pNextBrick-> speedAdjust = 3;
-            }
-            else if (row < 6)
-            {
-                pNextBrick->block.color = sf::Color(70, 70, 80); // dark grey
-                pNextBrick->points = 8;
-                pNextBrick-> speedAdjust = 4;
-            }
-            else
-            {
-                pNextBrick->block.color = sf::Color(255, 153, 51); // Light orange
-                pNextBrick->points = 12;
-                pNextBrick-> speedAdjust = 6;
-            }
+/**
+ * places a new life's balls on the paddle, ready to launch
+ * @param balls - ball set to refill with launchCount balls
+ * @param paddle - paddle the balls rest on
+ */
+void serveBalls(BallSet &balls, MovingBlock &paddle)
+{
+    balls.count = balls.launchCount;
 
+    Ball *pBall = &balls.balls[0];
+    for (int i = 0; i < balls.count; i++)
+    {
+        pBall->radius = BALL_RADIUS;
+        pBall->coordinateX = paddle.block.left + (PADDLE_WIDTH / 2.0);
+        pBall->coordinateY = paddle.block.top - BALL_RADIUS - 1;
+        pBall->velocityX = 0.0;
+        pBall->velocityY = 0.0;
+        pBall->color = BALL_COLOR;
+        pBall->speedLevel = 0;
+        pBall++;
+    }
+}
 
-            // drawing properties
-            pNextBrick->block.rectangle.setSize(sf::Vector2f(pNextBrick->block.width, pNextBrick->block.height));
-            pNextBrick->block.rectangle.setFillColor((pNextBrick->block.color));
-            pNextBrick->block.rectangle.setPosition(pNextBrick->block.left, pNextBrick->block.top);
 
-            pNextBrick->hit = false;
-            pNextBrick++;
-            bricksLeft += BRICK_WIDTH;
-        } // brick columns
-        bricksTop -= BRICK_HEIGHT;
-    } // brick rows
+/**
+ * sends the served balls off the paddle, each at its own angle
+ * @param balls - balls resting on the paddle
+ * @param delta - current frame time (picks the first ball's direction)
+ */
+void launchBalls(BallSet &balls, float delta)
+{
+    Ball *pBall = &balls.balls[0];
+    for (int i = 0; i < balls.count; i++)
+    {
+        // alternate sides and steepen evenly, so no two balls share a path
+        pBall->velocityX = BALL_SPEED_X * (1 - 0.7 * i / balls.count);
+        pBall->velocityY = BALL_SPEED_Y * -1;
+        if ((i & 1) != ((int(delta * 10) & 1) % 2))
+        {
+            pBall->velocityX *= -1;
+        }
+        pBall++;
+    }
 }
 
 /**
@@ -288,16 +344,17 @@ Direction processInput() {
 /**
  * update the state of game objects
  * @param input - user keyboard input
- * @param ball  - update ball position and speed
+ * @param balls - update ball positions and speeds
  * @param delta - current frame time
  * @param walls - the borders
  * @param paddle - user paddle block
  * @param started - game start check
  * @param bricks - structure array for bricks (passed to another function within)
- * @return bool - returns true if a game-ending collision occured
+ * @param stats - score and lives
+ * @return bool - returns true if the last life was lost or every brick was broken
  */
-bool update(Direction &input, Ball &ball, float delta, Borders walls,
-            MovingBlock &paddle, bool &started, Brick bricks[BRICK_ROWS][BRICK_COLUMNS]){
+bool update(Direction &input, BallSet &balls, float delta, Borders walls,
+            MovingBlock &paddle, bool &started, Brick bricks[BRICK_ROWS][BRICK_COLUMNS], GameStats &stats){
 
     bool gameOver = false;
     // adjust velocity directions for user input
@@ -318,18 +375,14 @@ bool update(Direction &input, Ball &ball, float delta, Borders walls,
             case Start:
                 if (!started)
                 {
-                    ball.velocityX = BALL_SPEED_X;
-                    ball.velocityY = BALL_SPEED_Y * -1;
-                    if ((int(delta * 10) & 1) % 2)
-                    {
-                        ball.velocityX *= -1;
-                    }
+                    launchBalls(balls, delta);
                     started = true;
                 }
                 break;
                 //case Start
             case Restart:
                 started = false;
+                serveBalls(balls, paddle);
                 restartCount++;
                 break;
 
@@ -340,85 +393,122 @@ bool update(Direction &input, Ball &ball, float delta, Borders walls,
     // adjust the location of the ball for speed * time
     paddle.block.left += paddle.velocityX * delta;
 
-    if (started)
+    Ball *pBall = &balls.balls[0];
+    for (int i = 0; i < balls.count; i++)
     {
-        ball.coordinateX += (ball.velocityX * delta);
-        ball.coordinateY += (ball.velocityY * delta);
+        if (started)
+        {
+            pBall->coordinateX += (pBall->velocityX * delta);
+            pBall->coordinateY += (pBall->velocityY * delta);
+        }
+        else
+        {
+            pBall->coordinateX = paddle.block.left + (PADDLE_WIDTH / 2.0);
+            pBall->coordinateY = paddle.block.top - BALL_RADIUS - 1;
+        }
+        pBall++;
     }
-    else
+
+    if (doCollisionChecks(balls, paddle, walls, bricks, stats)) // every ball reached the bottom wall
     {
-        ball.coordinateX = paddle.block.left + (PADDLE_WIDTH / 2.0);
-        ball.coordinateY = paddle.block.top - BALL_RADIUS - 1;
+        stats.lives--;
+        serveBalls(balls, paddle);
+        started = false;
     }
 
-    gameOver = doCollisionChecks(ball, paddle, walls, bricks);
+    gameOver = stats.lives <= 0 || stats.bricksLeft <= 0;
 
     return gameOver;
 } // end update
 
 
 /**
- * draw the ball on the graphics window
+ * draw the balls on the graphics window
  * @param window - handle to open graphics windowaa
- * @param ball   - structure variable with properties for the ball
+ * @param mesh   - drawing resources, created on the first call
+ * @param balls  - structure variable with properties for the balls
  * @param delta  - amount of frame time plus lag (in ms)
  * @param walls - the borders
  * @param paddle - structure variable with properties for the paddle
  * @param bricks - structure array with properties for the bricks
  */
-void render(sf::RenderWindow &window, Ball &ball, float delta, Borders walls, MovingBlock paddle,
-            Brick bricks[BRICK_ROWS][BRICK_COLUMNS]){
+void render(sf::RenderWindow &window, BoardMesh &mesh, BallSet &balls, float delta, Borders walls,
+            MovingBlock paddle, Brick bricks[BRICK_ROWS][BRICK_COLUMNS]){
+
+    if (!mesh.created)
+    {
+        createBoardMesh(mesh, walls, bricks);
+    }
 
     // Render drawing objects
     // ------------------------------------------------
     window.clear(WINDOW_COLOR);     // clear the window with the background color
 
-    // draw the ball
+    // draw the balls
     // ------------------------------------------------
-    sf::CircleShape circle;
-    circle.setFillColor(ball.color);
-    circle.setRadius(ball.radius);
-    circle.setOrigin(ball.radius,ball.radius);  // set screen coordinates relative to the center of the circle
+    sf::CircleShape &circle = mesh.ball;
 
-    // calculate current drawing location relative to speed and frame-time
-    float xCoordinate = (ball.coordinateX + (ball.velocityX * delta));
-    float yCoordinate = (ball.coordinateY + (ball.velocityY * delta));
+    Ball *pBall = &balls.balls[0];
+    for (int i = 0; i < balls.count; i++)
+    {
+        // calculate current drawing location relative to speed and frame-time
+        float xCoordinate = (pBall->coordinateX + (pBall->velocityX * delta));
+        float yCoordinate = (pBall->coordinateY + (pBall->velocityY * delta));
+
+        circle.setPosition(xCoordinate, yCoordinate);
+        window.draw(circle);
+        pBall++;
+    }
 
     float paddleXCoord = (paddle.block.left + (paddle.velocityX * delta));
     float paddleYCoord = (paddle.block.top + (paddle.velocityY * delta));
 
     // set paddles position
     //--------------------------------------------
-    paddle.block.rectangle.setPosition(paddleXCoord, paddleYCoord);
-    circle.setPosition(xCoordinate, yCoordinate);
-    window.draw(circle);
-    window.draw(paddle.block.rectangle);
+    mesh.paddle.setPosition(paddleXCoord, paddleYCoord);
+    window.draw(mesh.paddle);
 
 
-    // draw the window walls
-    window.draw(walls.leftBlock.rectangle);
-    window.draw(walls.topBlock.rectangle);
-    window.draw(walls.rightBlock.rectangle);
-    window.draw(walls.bottomBlock.rectangle);
-
-
-    // draw the bricks
+    // recolor the bricks damaged and hide the bricks broken since the last frame
+    sf::Vertex *pQuad = &mesh.vertices[WALL_QUADS * 4];
     Brick *pBrick = &bricks[0][0];
-    for (int row = 0; row < BRICK_ROWS; row++) // rows
+    for (int brick = 0; brick < BRICK_ROWS * BRICK_COLUMNS; brick++)
     {
-
-        for (int column = 0; column < BRICK_COLUMNS; column++) //columns
+        const BrickBehavior &behavior = BRICK_BEHAVIORS[pBrick->type];
+        sf::Color color = behavior.color;
+        if (pBrick->hit)
+        {
+            color = sf::Color::Transparent;
+        }
+        else if (pBrick->hitsLeft < behavior.hits)
         {
+            color = behavior.damagedColor;
+        }
 
-            if (!pBrick->hit)
+        if (pQuad->color != color)
+        {
+            for (int corner = 0; corner < 4; corner++)
             {
-                window.draw(pBrick->block.rectangle);
+                pQuad[corner].color = color;
             }
+            if (mesh.useBuffer)
+            {
+                mesh.buffer.update(pQuad, 4, (WALL_QUADS + brick) * 4);
+            }
+        }
+        pQuad += 4;
+        pBrick++;
+    }
 
-            pBrick++;
-        } // COLUMNS
-
-    } //  ROWS
+    // draw the window walls and the bricks
+    if (mesh.useBuffer)
+    {
+        window.draw(mesh.buffer);
+    }
+    else
+    {
+        window.draw(mesh.vertices);
+    }
 
     // display new window
     window.display();
@@ -426,184 +516,62 @@ void render(sf::RenderWindow &window, Ball &ball, float delta, Borders walls, Mo
 
 
 /**
- * determines the point using for collision detection
- * @param pBall - structure variable with properties for the ball
- * @param pBlock - structure variable with properties for the block
- * @return int - returns angle of heading from 1-360 degrees
+ * builds the shapes and the wall and brick vertices, uploading them to the GPU when possible
+ * @param mesh - drawing resources to create
+ * @param walls - the borders
+ * @param bricks - structure array with properties for the bricks
  */
-int getCollisionPoint(Ball* pBall, Block* pBlock)
+void createBoardMesh(BoardMesh &mesh, Borders &walls, Brick bricks[BRICK_ROWS][BRICK_COLUMNS])
 {
-    int heading = 0;
-    float checkPointX = 0.0;
-    float checkPointY = 0.0;
-
-    // horizontal collisions
-    //---------------------------------------------------------------
-    if (pBall->coordinateX < pBlock->left) // collision with left wall
-    {
-        checkPointX = pBlock->left;
-    }
-    else if (pBall->coordinateX > (pBlock->left + pBlock->width)) // collision with right wall
-    {
-        checkPointX = (pBlock->left + pBlock->width);
-
-    }else{
-        checkPointX = pBall->coordinateX;
-    }
+    mesh.paddle.setSize(sf::Vector2f(PADDLE_WIDTH, PADDLE_THICKNESS));
+    mesh.paddle.setFillColor(PADDLE_COLOR);
 
-    // vertical collisions
-    //---------------------------------------------------------------
-    if (pBall->coordinateY < pBlock->top) // collision with top wall
-    {
-        checkPointY = pBlock->top;
-    }
-    else if (pBall->coordinateY > (pBlock->top + pBlock->height)) // collision with bottom wall
-    {
-        checkPointY = (pBlock->top + pBlock->height);
+    mesh.ball.setFillColor(BALL_COLOR);
+    mesh.ball.setRadius(BALL_RADIUS);
+    mesh.ball.setOrigin(BALL_RADIUS, BALL_RADIUS);  // set screen coordinates relative to the center of the circle
 
-    }else{
-        checkPointY = pBall->coordinateY;
-    }
+    // one quad per wall, then one per brick
+    int vertexCount = (WALL_QUADS + BRICK_ROWS * BRICK_COLUMNS) * 4;
+    mesh.vertices = sf::VertexArray(sf::Quads, vertexCount);
 
-    float differenceX = checkPointX - pBall->coordinateX;
-    float differenceY = ((WINDOW_HEIGHT - checkPointY) - (WINDOW_HEIGHT - pBall->coordinateY));
-    double distance = sqrt(pow(differenceX, 2.0) + pow(differenceY, 2.0));
+    setQuad(&mesh.vertices[0], walls.leftBlock);
+    setQuad(&mesh.vertices[4], walls.topBlock);
+    setQuad(&mesh.vertices[8], walls.rightBlock);
+    setQuad(&mesh.vertices[12], walls.bottomBlock);
 
-    if (distance <= pBall->radius)
+    sf::Vertex *pQuad = &mesh.vertices[WALL_QUADS * 4];
+    Brick *pBrick = &bricks[0][0];
+    for (int brick = 0; brick < BRICK_ROWS * BRICK_COLUMNS; brick++)
     {
-        double theta = atan2(differenceY, differenceX);
-        double degrees = 90.0 - theta * 180 / M_PI;
-        if (degrees <= 0)
-        {
-            degrees += 360;
-        }
-        heading = int(degrees);
+        setQuad(pQuad, pBrick->block);
+        pQuad += 4;
+        pBrick++;
     }
-    return heading;
-}
-
-
-/**
- * checks for collision using the heading from getCollisionPoint
- * @param pBall - structure variable with properties for the ball
- * @param pBlock - structure variable with properties for the block
- * @return bool - returns true if collision detected, false if not
- */
-bool collisionCheck(Ball *pBall, Block *pBlock)
-{
-    bool bCollided = false;
-    int collision = getCollisionPoint(pBall, pBlock);
 
-    if (collision)
+    mesh.useBuffer = sf::VertexBuffer::isAvailable() && mesh.buffer.create(vertexCount);
+    if (mesh.useBuffer)
     {
-        bCollided = true;
-        if (collision > 225 && collision < 315) // left
-        {
-            pBall->velocityX *= -1;
-            pBall->coordinateX = (pBlock->left + pBlock->width + pBall->radius + 1);
-        }
-        else if (collision > 45 && collision < 135) // top
-        {
-            pBall->velocityX *= -1;
-            pBall->coordinateX = (pBlock->left - pBall->radius - 1);
-        }
-
-        if (collision >= 315 || collision <= 45) // right
-        {
-            pBall->velocityY *= -1;
-            pBall->coordinateY = (pBlock->top + pBlock->height + pBall->radius + 1);
-        }
-        else if (collision >= 135 && collision <= 225) // bottom
-        {
-            pBall->velocityY *= -1;
-            pBall->coordinateY = (pBlock->top - pBall->radius - 1);
-        }
+        mesh.buffer.setPrimitiveType(sf::Quads);
+        mesh.buffer.setUsage(sf::VertexBuffer::Dynamic);
+        mesh.buffer.update(&mesh.vertices[0]);
     }
-    return bCollided;
-}
-
-
-/**
- * checks for collision using the properties of moving and stationary blocks
- * @param moving - structure variable with properties for the moving block (paddle)
- * @param stationary - structure variable with properties for the stationary block (brick)
- * @return bool - returns true if collision detected, false if not
- */
-bool checkBlockCollision(Block moving, Block stationary)
-{
-    bool collision = false;
-    if (moving.left < stationary.left + stationary.width &&
 
-        moving.left + moving.width > stationary.left &&
-
-        moving.top < stationary.top + stationary.height &&
-
-        moving.top + moving.height > stationary.top)
-
-    {
-        collision = true;
-    }
-    return collision;
+    mesh.created = true;
 }
 
 
 /**
- * @param ball = ball for collision checks
- * @param paddle = paddle for collision checks
- * @param walls = game walls
- * @param bricks = point bricks to break
- * @return bool = returns true if a collision happened, false if not
+ * fills in the four corners of a block's quad
+ * @param pQuad - first of the quad's four vertices
+ * @param block - block to draw
  */
-bool doCollisionChecks (Ball &ball, MovingBlock &paddle, Borders walls, Brick bricks[BRICK_ROWS][BRICK_COLUMNS])
+void setQuad(sf::Vertex *pQuad, const Block &block)
 {
-    bool gameOver = false;
-    // vertical collision checks
-    //-----------------------------------------
-    if (!collisionCheck(&ball, &paddle.block))
-    {
-        if (!collisionCheck(&ball, &walls.topBlock))
-        {
-            gameOver = collisionCheck(&ball, &walls.bottomBlock);
-        }
-    }
+    float right = block.left + block.width;
+    float bottom = block.top + block.height;
 
-    // horizontal collision checks
-    //-----------------------------------------
-    if (!collisionCheck(&ball, &walls.leftBlock))
-    {
-        collisionCheck(&ball, &walls.rightBlock);
-    }
-
-    // paddle-wall collision checks
-    //-----------------------------------------
-    if (checkBlockCollision(paddle.block, walls.leftBlock))
-    {
-        paddle.block.left = walls.leftBlock.left + walls.leftBlock.width + 1;
-        paddle.velocityX = 0;
-    }
-
-    else if (checkBlockCollision(paddle.block, walls.rightBlock))
-    {
-        paddle.block.left = walls.rightBlock.left - paddle.block.width - 1;
-        paddle.velocityX = 0;
-    }
-
-
-    Brick *pBrick = &bricks[0][0];
-    for (int row = 0; row < BRICK_ROWS; row++)
-    {
-
-        for (int column = 0; column < BRICK_COLUMNS; column++)
-        {
-
-            if (!pBrick->hit)
-            {
-                pBrick->hit = collisionCheck(&ball, &pBrick->block);
-            }
-            pBrick++;
-
-        } // COLUMNS
-
-    } // ROWS
-    return gameOver;
+    pQuad[0] = sf::Vertex(sf::Vector2f(block.left, block.top), block.color);
+    pQuad[1] = sf::Vertex(sf::Vector2f(right, block.top), block.color);
+    pQuad[2] = sf::Vertex(sf::Vector2f(right, bottom), block.color);
+    pQuad[3] = sf::Vertex(sf::Vector2f(block.left, bottom), block.color);
 }
@@ -8,37 +8,43 @@
 #define BREAKOUTPADDLES_CPP_BREAKOUT_DEFS_H
 
 //ball properties
-const float BALL_RADIUS = 10.0;
+constexpr float BALL_RADIUS = 10.0;
+const int MAX_BALLS = 512; // most balls in play at once (multi-ball and stress runs)
 
 //paddle properties
-const float PADDLE_WIDTH = 80.0;
-const float PADDLE_THICKNESS = 10.0;
+constexpr float PADDLE_WIDTH = 80.0;
+constexpr float PADDLE_THICKNESS = 10.0;
 const sf::Color PADDLE_COLOR = sf::Color::White;
 const float PADDLE_SPEED = PADDLE_WIDTH / 10.0 / 1000.0 ; //adjust the 10 to change paddle speed
 
 
 //border properties
-const float WALL_THICKNESS = 15.0;
+constexpr float WALL_THICKNESS = 15.0;
 const sf::Color WALL_COLOR = sf::Color(255, 119, 0); // darker orange
 
 // window properties
-const int WINDOW_WIDTH = 800;
-const int WINDOW_HEIGHT = 480;
+constexpr int WINDOW_WIDTH = 800;
+constexpr int WINDOW_HEIGHT = 480;
 const sf::Color WINDOW_COLOR = sf::Color::Black;
 
 // drawing properties
 const float FRAME_RATE = (1.0/30.0) * 1000.0;  // FPS in ms
+const int HEADLESS_FRAMES = 10000; // default frame limit for --headless runs
 const sf::Color BALL_COLOR = sf::Color(255, 153, 51); // light orange
 
 //brick properties
-const int BRICK_ROWS = 8;
-const int BRICK_COLUMNS = 14;
-const float BRICK_WIDTH = WINDOW_WIDTH / BRICK_COLUMNS;
-const float BRICK_HEIGHT = PADDLE_THICKNESS * 2;
-const float BRICKS_HEIGHT = BRICK_ROWS * BRICK_HEIGHT;
-const float BRICKS_TOP = WINDOW_HEIGHT/2.0 - BRICKS_HEIGHT * 0.75;
-const float BRICKS_LEFT = WALL_THICKNESS;
-const float FIRST_BRICK = BRICKS_TOP + (BRICK_ROWS - 1) * BRICK_HEIGHT;
+constexpr int BRICK_ROWS = 8;
+constexpr int BRICK_COLUMNS = 14;
+constexpr float BRICK_WIDTH = WINDOW_WIDTH / BRICK_COLUMNS;
+constexpr float BRICK_HEIGHT = PADDLE_THICKNESS * 2;
+constexpr float BRICKS_HEIGHT = BRICK_ROWS * BRICK_HEIGHT;
+constexpr float BRICKS_TOP = WINDOW_HEIGHT/2.0 - BRICKS_HEIGHT * 0.75;
+constexpr float BRICKS_LEFT = WALL_THICKNESS;
+constexpr float FIRST_BRICK = BRICKS_TOP + (BRICK_ROWS - 1) * BRICK_HEIGHT;
+
+//game properties
+const int START_LIVES = 3;
+const float BALL_SPEEDUP = 0.05; // fraction of base speed added per point of brick speedAdjust
 
 
 // These are just for fun
@@ -48,7 +54,7 @@ const float SPEED_TIME = (3.0 * 1000.0) * 30.0;             //
 const float BALL_SPEED_X = BALL_RADIUS * 10.0 / 1000.0;    // speed horizontally
 const float BALL_SPEED_Y = BALL_RADIUS * 8.5 / 1000.0;   // span  vertically
 
-int restartCount;
+inline int restartCount;
 
 
 // Type definitions
@@ -76,7 +82,15 @@ struct Ball {
     float velocityX;   // current horizontal speed X
     float velocityY;   // current vertical speed Y
     sf::Color color;   // fill color
+    float speedLevel;  // highest brick speedAdjust reached by this ball
+
+};
 
+// every ball in play, packed at the front of the array
+struct BallSet {
+    Ball balls[MAX_BALLS];
+    int count;       // balls currently in play
+    int launchCount; // balls served at the start of each life
 };
 
 //wall structure
@@ -86,13 +100,11 @@ struct Block {
     float width;
     float height;
     sf::Color color;
-    sf::RectangleShape rectangle;
 };
 
 // MOVING BLOCK STRUCT
 struct MovingBlock {
     Block block;
-    sf::RectangleShape rectangle;
     float velocityX;   // current horizontal speed X
     float velocityY;   // current vertical speed Y
 
@@ -106,12 +118,103 @@ struct Borders{
     Block bottomBlock;
 };
 
+// brick types, one per pair of rows (bottom row first)
+enum BrickType{
+    WhiteBrick,
+    LightGreyBrick,
+    DarkGreyBrick,
+    OrangeBrick,
+    BRICK_TYPES
+};
+
+// per-type brick behavior, looked up by Brick::type on every hit
+struct BrickBehavior{
+    sf::Color color;
+    sf::Color damagedColor; // color once hit but not yet broken
+    int points;        // score for breaking the brick
+    int hits;          // hits needed to break the brick
+    float speedAdjust; // ball speed level reached when this brick is hit
+    int extraBalls;    // balls split off the hitting ball when the brick breaks
+};
+
+const BrickBehavior BRICK_BEHAVIORS[BRICK_TYPES] = {
+    {sf::Color::White,         sf::Color::White,         1, 1, 0, 0}, // white
+    {sf::Color(112, 121, 121), sf::Color(112, 121, 121), 4, 1, 3, 0}, // light grey
+    {sf::Color(70, 70, 80),    sf::Color(40, 40, 46),    8, 2, 4, 0}, // dark grey
+    {sf::Color(255, 153, 51),  sf::Color(150, 90, 30),  12, 2, 6, 1}  // light orange
+};
+
+// brick type for each row
+const BrickType BRICK_ROW_TYPES[BRICK_ROWS] = {
+    WhiteBrick, WhiteBrick,
+    LightGreyBrick, LightGreyBrick,
+    DarkGreyBrick, DarkGreyBrick,
+    OrangeBrick, OrangeBrick
+};
+
 struct Brick{
     Block block;
     bool hit;
-    int points;
-    float speedAdjust;
+    int type;     // index into BRICK_BEHAVIORS
+    int hitsLeft; // hits remaining before the brick breaks
+};
+
+// score and lives tracking
+struct GameStats{
+    int score;
+    int lives;
+    int bricksLeft;
+};
+
+
+// Static board geometry
+// --------------------------------------------------------
+
+// position and size of a block that never moves
+struct BlockGeometry {
+    float left;
+    float top;
+    float width;
+    float height;
+};
+
+// walls and bricks as laid out at the start of every game
+struct BoardLayout {
+    BlockGeometry leftWall;
+    BlockGeometry topWall;
+    BlockGeometry rightWall;
+    BlockGeometry bottomWall;
+    BlockGeometry bricks[BRICK_ROWS][BRICK_COLUMNS];
 };
 
+/**
+ * lays out the walls and bricks (evaluated at compile time into BOARD_LAYOUT)
+ * @return BoardLayout - the starting board
+ */
+constexpr BoardLayout makeBoardLayout()
+{
+    BoardLayout layout{};
+
+    layout.leftWall = {0.0, 0.0, WALL_THICKNESS, WINDOW_HEIGHT};
+    layout.topWall = {0.0, 0.0, WINDOW_WIDTH, WALL_THICKNESS};
+    layout.rightWall = {WINDOW_WIDTH - WALL_THICKNESS, 0.0, WALL_THICKNESS, WINDOW_HEIGHT};
+    layout.bottomWall = {0.0, WINDOW_HEIGHT - WALL_THICKNESS, WINDOW_WIDTH, WALL_THICKNESS};
+
+    float bricksTop = FIRST_BRICK; // start at lowest brick row
+    for (int row = 0; row < BRICK_ROWS; row++)
+    {
+        float bricksLeft = BRICKS_LEFT; // far left bricks
+        for (int column = 0; column < BRICK_COLUMNS; column++)
+        {
+            // offset left and top by 1 and shrink by 2 for a 1-pixel gap
+            layout.bricks[row][column] = {bricksLeft + 1, bricksTop + 1, BRICK_WIDTH - 2, BRICK_HEIGHT - 2};
+            bricksLeft += BRICK_WIDTH;
+        }
+        bricksTop -= BRICK_HEIGHT;
+    }
+    return layout;
+}
+
+constexpr BoardLayout BOARD_LAYOUT = makeBoardLayout();
 
 #endif //BREAKOUTPADDLES_CPP_BREAKOUT_DEFS_H
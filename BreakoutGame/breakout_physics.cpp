@@ -0,0 +1,348 @@
+/* --------------------------------------------------------
+ *    File: breakout_physics.cpp
+ *  Author: Justin Rubio
+ * Purpose: Ball, paddle, wall and brick collisions
+ * -------------------------------------------------------- */
+
+#include <cmath>                //  for trig/geometry/linear functions
+#include <algorithm>
+#include "breakout_defs.h"
+#include "breakout_physics.h"
+
+
+/**
+ * makes a block from its precomputed position and size
+ * @param geometry - position and size from BOARD_LAYOUT
+ * @param color - fill color
+ * @return Block - the placed block
+ */
+Block makeBlock(const BlockGeometry &geometry, sf::Color color)
+{
+    Block block;
+    block.left = geometry.left;
+    block.top = geometry.top;
+    block.width = geometry.width;
+    block.height = geometry.height;
+    block.color = color;
+    return block;
+}
+
+
+/**
+ * determines the point using for collision detection
+ * @param pBall - structure variable with properties for the ball
+ * @param pBlock - structure variable with properties for the block
+ * @return int - returns angle of heading from 1-360 degrees
+ */
+int getCollisionPoint(Ball* pBall, Block* pBlock)
+{
+    int heading = 0;
+    float checkPointX = 0.0;
+    float checkPointY = 0.0;
+
+    // horizontal collisions
+    //---------------------------------------------------------------
+    if (pBall->coordinateX < pBlock->left) // collision with left wall
+    {
+        checkPointX = pBlock->left;
+    }
+    else if (pBall->coordinateX > (pBlock->left + pBlock->width)) // collision with right wall
+    {
+        checkPointX = (pBlock->left + pBlock->width);
+
+    }else{
+        checkPointX = pBall->coordinateX;
+    }
+
+    // vertical collisions
+    //---------------------------------------------------------------
+    if (pBall->coordinateY < pBlock->top) // collision with top wall
+    {
+        checkPointY = pBlock->top;
+    }
+    else if (pBall->coordinateY > (pBlock->top + pBlock->height)) // collision with bottom wall
+    {
+        checkPointY = (pBlock->top + pBlock->height);
+
+    }else{
+        checkPointY = pBall->coordinateY;
+    }
+
+    float differenceX = checkPointX - pBall->coordinateX;
+    float differenceY = ((WINDOW_HEIGHT - checkPointY) - (WINDOW_HEIGHT - pBall->coordinateY));
+    double distance = sqrt(pow(differenceX, 2.0) + pow(differenceY, 2.0));
+
+    if (distance <= pBall->radius)
+    {
+        double theta = atan2(differenceY, differenceX);
+        double degrees = 90.0 - theta * 180 / M_PI;
+        if (degrees <= 0)
+        {
+            degrees += 360;
+        }
+        heading = int(degrees);
+    }
+    return heading;
+}
+
+
+/**
+ * checks for collision using the heading from getCollisionPoint
+ * @param pBall - structure variable with properties for the ball
+ * @param pBlock - structure variable with properties for the block
+ * @return bool - returns true if collision detected, false if not
+ */
+bool collisionCheck(Ball *pBall, Block *pBlock)
+{
+    bool bCollided = false;
+    int collision = getCollisionPoint(pBall, pBlock);
+
+    if (collision)
+    {
+        bCollided = true;
+        if (collision > 225 && collision < 315) // left
+        {
+            pBall->velocityX *= -1;
+            pBall->coordinateX = (pBlock->left + pBlock->width + pBall->radius + 1);
+        }
+        else if (collision > 45 && collision < 135) // top
+        {
+            pBall->velocityX *= -1;
+            pBall->coordinateX = (pBlock->left - pBall->radius - 1);
+        }
+
+        if (collision >= 315 || collision <= 45) // right
+        {
+            pBall->velocityY *= -1;
+            pBall->coordinateY = (pBlock->top + pBlock->height + pBall->radius + 1);
+        }
+        else if (collision >= 135 && collision <= 225) // bottom
+        {
+            pBall->velocityY *= -1;
+            pBall->coordinateY = (pBlock->top - pBall->radius - 1);
+        }
+    }
+    return bCollided;
+}
+
+
+/**
+ * checks for collision using the properties of moving and stationary blocks
+ * @param moving - structure variable with properties for the moving block (paddle)
+ * @param stationary - structure variable with properties for the stationary block (brick)
+ * @return bool - returns true if collision detected, false if not
+ */
+bool checkBlockCollision(Block moving, Block stationary)
+{
+    bool collision = false;
+    if (moving.left < stationary.left + stationary.width &&
+
+        moving.left + moving.width > stationary.left &&
+
+        moving.top < stationary.top + stationary.height &&
+
+        moving.top + moving.height > stationary.top)
+
+    {
+        collision = true;
+    }
+    return collision;
+}
+
+
+/**
+ * applies one ball hit to a brick using its type's entry in BRICK_BEHAVIORS
+ * @param pBrick - brick that was hit
+ * @param balls - balls in play (extra balls are split off the hitting ball)
+ * @param ballIndex - ball that hit the brick (sped up to the brick's level)
+ * @param stats - score to update
+ */
+void hitBrick(Brick *pBrick, BallSet &balls, int ballIndex, GameStats &stats)
+{
+    const BrickBehavior &behavior = BRICK_BEHAVIORS[pBrick->type];
+    Ball &ball = balls.balls[ballIndex];
+
+    pBrick->hitsLeft--;
+    pBrick->hit = pBrick->hitsLeft <= 0;
+
+    // points only count once the brick breaks
+    stats.score += behavior.points * pBrick->hit;
+    stats.bricksLeft -= pBrick->hit;
+
+    // raise the ball to the brick's speed level, never slowing it down
+    float speedLevel = std::max(ball.speedLevel, behavior.speedAdjust);
+    float speedUp = (1 + speedLevel * BALL_SPEEDUP) / (1 + ball.speedLevel * BALL_SPEEDUP);
+    ball.velocityX *= speedUp;
+    ball.velocityY *= speedUp;
+    ball.speedLevel = speedLevel;
+
+    // multi-ball bricks split mirrored copies off the ball when they break
+    int extraBalls = std::min(behavior.extraBalls * pBrick->hit, MAX_BALLS - balls.count);
+    for (int i = 0; i < extraBalls; i++)
+    {
+        Ball &extra = balls.balls[balls.count++];
+        extra = ball;
+        extra.velocityX *= -1;
+    }
+}
+
+
+/**
+ * finds the rows and columns of brick cells a ball can touch from where it is now
+ * (rows and columns outside the grid are clipped, so the range may be empty)
+ * @param pBall - ball to look up
+ * @param firstRow, lastRow - rows the ball overlaps
+ * @param firstColumn, lastColumn - columns the ball overlaps
+ */
+void brickRange(Ball *pBall, int &firstRow, int &lastRow, int &firstColumn, int &lastColumn)
+{
+    // pad by a pixel so float rounding never drops a touching brick
+    float reach = pBall->radius + 1;
+
+    // row 0 is the lowest row, so rows count up as y goes down the screen
+    float rowBottom = FIRST_BRICK + BRICK_HEIGHT;
+    float top = std::clamp((rowBottom - (pBall->coordinateY + reach)) / BRICK_HEIGHT, -1.0f, float(BRICK_ROWS));
+    float bottom = std::clamp((rowBottom - (pBall->coordinateY - reach)) / BRICK_HEIGHT, -1.0f, float(BRICK_ROWS));
+    float left = std::clamp((pBall->coordinateX - reach - BRICKS_LEFT) / BRICK_WIDTH, -1.0f, float(BRICK_COLUMNS));
+    float right = std::clamp((pBall->coordinateX + reach - BRICKS_LEFT) / BRICK_WIDTH, -1.0f, float(BRICK_COLUMNS));
+
+    firstRow = std::max(int(std::floor(top)), 0);
+    lastRow = std::min(int(std::floor(bottom)), BRICK_ROWS - 1);
+    firstColumn = std::max(int(std::floor(left)), 0);
+    lastColumn = std::min(int(std::floor(right)), BRICK_COLUMNS - 1);
+}
+
+
+/**
+ * moves one ball off the paddle, walls and bricks. Only the brick cells around the ball are
+ * tested, in the same row-by-row order as a full scan; bricks it hits are claimed, not broken.
+ * @param pBall = ball for collision checks
+ * @param paddle = paddle for collision checks
+ * @param walls = game walls
+ * @param bricks = point bricks to check
+ * @param ballIndex = number of the ball in its ball set
+ * @param brickClaims = lowest ball number to hit each brick this step, lowered for bricks this ball hits
+ * @return bool = returns true if the ball hit the bottom wall, false if not
+ */
+bool collideBall (Ball *pBall, MovingBlock &paddle, Borders &walls, Brick bricks[BRICK_ROWS][BRICK_COLUMNS],
+                  int ballIndex, int brickClaims[BRICK_ROWS * BRICK_COLUMNS])
+{
+    bool ballLost = false;
+
+    // vertical collision checks
+    //-----------------------------------------
+    if (!collisionCheck(pBall, &paddle.block))
+    {
+        if (!collisionCheck(pBall, &walls.topBlock))
+        {
+            ballLost = collisionCheck(pBall, &walls.bottomBlock);
+        }
+    }
+
+    // horizontal collision checks
+    //-----------------------------------------
+    if (!collisionCheck(pBall, &walls.leftBlock))
+    {
+        collisionCheck(pBall, &walls.rightBlock);
+    }
+
+    // brick collision checks
+    //-----------------------------------------
+    int firstRow, lastRow, firstColumn, lastColumn;
+    brickRange(pBall, firstRow, lastRow, firstColumn, lastColumn);
+
+    int row = firstRow;
+    int column = firstColumn;
+    while (row <= lastRow)
+    {
+        if (column > lastColumn)
+        {
+            row++;
+            column = firstColumn;
+            continue;
+        }
+
+        Brick *pBrick = &bricks[row][column];
+        if (!pBrick->hit && collisionCheck(pBall, &pBrick->block))
+        {
+            int *pClaim = &brickClaims[row * BRICK_COLUMNS + column];
+            *pClaim = std::min(*pClaim, ballIndex);
+
+            // the bounce moved the ball, so carry on from here over the cells it now touches
+            int hitRow = row;
+            brickRange(pBall, firstRow, lastRow, firstColumn, lastColumn);
+            row = std::max(row, firstRow);
+            column = row == hitRow ? std::max(column, firstColumn - 1) : firstColumn - 1;
+        }
+        column++;
+    }
+    return ballLost;
+}
+
+
+/**
+ * moves every ball off the paddle, walls and bricks in one pass, then breaks the hit bricks.
+ * When several balls hit the same brick in one step they all bounce, but only the lowest
+ * numbered ball scores the hit.
+ * @param balls = balls for collision checks (balls that hit the bottom wall are removed)
+ * @param paddle = paddle for collision checks
+ * @param walls = game walls
+ * @param bricks = point bricks to break
+ * @param stats = score updated for broken bricks
+ * @return bool = returns true if every ball hit the bottom wall, false if not
+ */
+bool doCollisionChecks (BallSet &balls, MovingBlock &paddle, Borders walls, Brick bricks[BRICK_ROWS][BRICK_COLUMNS],
+                        GameStats &stats)
+{
+    bool ballLost[MAX_BALLS];
+    int brickClaims[BRICK_ROWS * BRICK_COLUMNS]; // lowest ball to hit each brick this step
+    std::fill(brickClaims, brickClaims + BRICK_ROWS * BRICK_COLUMNS, MAX_BALLS);
+
+    int checkedCount = balls.count;
+    Ball *pBall = &balls.balls[0];
+    for (int i = 0; i < checkedCount; i++)
+    {
+        ballLost[i] = collideBall(pBall, paddle, walls, bricks, i, brickClaims);
+        pBall++;
+    }
+
+    // paddle-wall collision checks
+    //-----------------------------------------
+    if (checkBlockCollision(paddle.block, walls.leftBlock))
+    {
+        paddle.block.left = walls.leftBlock.left + walls.leftBlock.width + 1;
+        paddle.velocityX = 0;
+    }
+
+    else if (checkBlockCollision(paddle.block, walls.rightBlock))
+    {
+        paddle.block.left = walls.rightBlock.left - paddle.block.width - 1;
+        paddle.velocityX = 0;
+    }
+
+    // break the claimed bricks
+    //-----------------------------------------
+    Brick *pBrick = &bricks[0][0];
+    for (int brick = 0; brick < BRICK_ROWS * BRICK_COLUMNS; brick++)
+    {
+        if (brickClaims[brick] < MAX_BALLS)
+        {
+            hitBrick(pBrick, balls, brickClaims[brick], stats);
+        }
+        pBrick++;
+    }
+
+    // drop lost balls, keeping the rest packed in order
+    //-----------------------------------------
+    int kept = 0;
+    for (int i = 0; i < balls.count; i++)
+    {
+        if (i >= checkedCount || !ballLost[i])
+        {
+            balls.balls[kept++] = balls.balls[i];
+        }
+    }
+    balls.count = kept;
+
+    return balls.count == 0;
+}
@@ -0,0 +1,24 @@
+/* --------------------------------------------------------
+ *    File: breakout_physics.h
+ *  Author: Justin Rubio
+ * -------------------------------------------------------- */
+
+#include "breakout_defs.h"
+#ifndef BREAKOUTPADDLES_CPP_BREAKOUT_PHYSICS_H
+#define BREAKOUTPADDLES_CPP_BREAKOUT_PHYSICS_H
+
+// Function declarations
+// --------------------------------------------------------
+
+Block makeBlock(const BlockGeometry &geometry, sf::Color color);
+int getCollisionPoint(Ball *pBall, Block *pBlock);
+bool checkBlockCollision(Block moving, Block stationary);
+bool collisionCheck(Ball *pBall, Block *pBlock);
+void hitBrick(Brick *pBrick, BallSet &balls, int ballIndex, GameStats &stats);
+void brickRange(Ball *pBall, int &firstRow, int &lastRow, int &firstColumn, int &lastColumn);
+bool collideBall (Ball *pBall, MovingBlock &paddle, Borders &walls, Brick bricks[BRICK_ROWS][BRICK_COLUMNS],
+                  int ballIndex, int brickClaims[BRICK_ROWS * BRICK_COLUMNS]);
+bool doCollisionChecks (BallSet &balls, MovingBlock &paddle, Borders walls, Brick bricks[BRICK_ROWS][BRICK_COLUMNS],
+                        GameStats &stats);
+
+#endif //BREAKOUTPADDLES_CPP_BREAKOUT_PHYSICS_H
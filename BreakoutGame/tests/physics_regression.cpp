@@ -0,0 +1,845 @@
+/* --------------------------------------------------------
+ *    File: physics_regression.cpp
+ *  Author: Justin Rubio
+ * Purpose: Checks the optimized collision code against the original
+ *          scalar collision code on random game states
+ * -------------------------------------------------------- */
+
+#include <SFML/Graphics.hpp>
+#include <cmath>                //  for trig/geometry/linear functions
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "breakout_defs.h"
+#include "breakout_physics.h"
+
+const int MAX_REPORTS = 10; // divergences printed in full
+const int MAX_TEST_BALLS = 8; // most balls in a multi-ball case
+
+// kinds of divergence, counted separately
+enum Divergence {
+    Bounce,
+    Position,
+    BallLost,
+    BrickHit,
+    Paddle,
+    BrickClaim,
+    ProcessOrder,
+    Score,
+    SpeedUp,
+    BallCount,
+    DIVERGENCES
+};
+
+const char *DIVERGENCE_NAMES[DIVERGENCES] = {
+    "bounce direction", "position", "ball lost", "brick hit", "paddle", "brick claim", "processing order",
+    "score", "speed-up", "ball count"
+};
+
+
+// The original scalar collision code, kept as it was as the reference
+// (calls are qualified so they never reach the optimized versions)
+// --------------------------------------------------------
+namespace reference {
+
+int getCollisionPoint(Ball* pBall, Block* pBlock)
+{
+    int heading = 0;
+    float checkPointX = 0.0;
+    float checkPointY = 0.0;
+
+    // horizontal collisions
+    //---------------------------------------------------------------
+    if (pBall->coordinateX < pBlock->left) // collision with left wall
+    {
+        checkPointX = pBlock->left;
+    }
+    else if (pBall->coordinateX > (pBlock->left + pBlock->width)) // collision with right wall
+    {
+        checkPointX = (pBlock->left + pBlock->width);
+
+    }else{
+        checkPointX = pBall->coordinateX;
+    }
+
+    // vertical collisions
+    //---------------------------------------------------------------
+    if (pBall->coordinateY < pBlock->top) // collision with top wall
+    {
+        checkPointY = pBlock->top;
+    }
+    else if (pBall->coordinateY > (pBlock->top + pBlock->height)) // collision with bottom wall
+    {
+        checkPointY = (pBlock->top + pBlock->height);
+
+    }else{
+        checkPointY = pBall->coordinateY;
+    }
+
+    float differenceX = checkPointX - pBall->coordinateX;
+    float differenceY = ((WINDOW_HEIGHT - checkPointY) - (WINDOW_HEIGHT - pBall->coordinateY));
+    double distance = sqrt(pow(differenceX, 2.0) + pow(differenceY, 2.0));
+
+    if (distance <= pBall->radius)
+    {
+        double theta = atan2(differenceY, differenceX);
+        double degrees = 90.0 - theta * 180 / M_PI;
+        if (degrees <= 0)
+        {
+            degrees += 360;
+        }
+        heading = int(degrees);
+    }
+    return heading;
+}
+
+bool collisionCheck(Ball *pBall, Block *pBlock)
+{
+    bool bCollided = false;
+    int collision = reference::getCollisionPoint(pBall, pBlock);
+
+    if (collision)
+    {
+        bCollided = true;
+        if (collision > 225 && collision < 315) // left
+        {
+            pBall->velocityX *= -1;
+            pBall->coordinateX = (pBlock->left + pBlock->width + pBall->radius + 1);
+        }
+        else if (collision > 45 && collision < 135) // top
+        {
+            pBall->velocityX *= -1;
+            pBall->coordinateX = (pBlock->left - pBall->radius - 1);
+        }
+
+        if (collision >= 315 || collision <= 45) // right
+        {
+            pBall->velocityY *= -1;
+            pBall->coordinateY = (pBlock->top + pBlock->height + pBall->radius + 1);
+        }
+        else if (collision >= 135 && collision <= 225) // bottom
+        {
+            pBall->velocityY *= -1;
+            pBall->coordinateY = (pBlock->top - pBall->radius - 1);
+        }
+    }
+    return bCollided;
+}
+
+bool checkBlockCollision(Block moving, Block stationary)
+{
+    bool collision = false;
+    if (moving.left < stationary.left + stationary.width &&
+
+        moving.left + moving.width > stationary.left &&
+
+        moving.top < stationary.top + stationary.height &&
+
+        moving.top + moving.height > stationary.top)
+
+    {
+        collision = true;
+    }
+    return collision;
+}
+
+bool doCollisionChecks (Ball &ball, MovingBlock &paddle, Borders walls, Brick bricks[BRICK_ROWS][BRICK_COLUMNS])
+{
+    bool gameOver = false;
+    // vertical collision checks
+    //-----------------------------------------
+    if (!reference::collisionCheck(&ball, &paddle.block))
+    {
+        if (!reference::collisionCheck(&ball, &walls.topBlock))
+        {
+            gameOver = reference::collisionCheck(&ball, &walls.bottomBlock);
+        }
+    }
+
+    // horizontal collision checks
+    //-----------------------------------------
+    if (!reference::collisionCheck(&ball, &walls.leftBlock))
+    {
+        reference::collisionCheck(&ball, &walls.rightBlock);
+    }
+
+    // paddle-wall collision checks
+    //-----------------------------------------
+    if (reference::checkBlockCollision(paddle.block, walls.leftBlock))
+    {
+        paddle.block.left = walls.leftBlock.left + walls.leftBlock.width + 1;
+        paddle.velocityX = 0;
+    }
+
+    else if (reference::checkBlockCollision(paddle.block, walls.rightBlock))
+    {
+        paddle.block.left = walls.rightBlock.left - paddle.block.width - 1;
+        paddle.velocityX = 0;
+    }
+
+
+    Brick *pBrick = &bricks[0][0];
+    for (int row = 0; row < BRICK_ROWS; row++)
+    {
+
+        for (int column = 0; column < BRICK_COLUMNS; column++)
+        {
+
+            if (!pBrick->hit)
+            {
+                pBrick->hit = reference::collisionCheck(&ball, &pBrick->block);
+            }
+            pBrick++;
+
+        } // COLUMNS
+
+    } // ROWS
+    return gameOver;
+}
+
+} // namespace reference
+//-----------------------------------------------------------
+
+
+// random numbers (splitmix64), one stream per test case so any case can be rerun alone
+struct Random {
+    std::uint64_t state;
+
+    std::uint64_t next()
+    {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    float uniform(float low, float high)
+    {
+        return low + (high - low) * (float(next() >> 40) / float(1 << 24));
+    }
+
+    bool chance(float odds)
+    {
+        return uniform(0, 1) < odds;
+    }
+};
+
+// one random game state, taken just before collision checks
+struct TestCase {
+    Ball ball;
+    MovingBlock paddle;
+    Borders walls;
+    Brick bricks[BRICK_ROWS][BRICK_COLUMNS];
+};
+
+// counts of each kind of divergence
+struct Results {
+    long long counts[DIVERGENCES];
+};
+
+// what breaking the claimed bricks should do, worked out from BRICK_BEHAVIORS alone
+struct ExpectedHits {
+    Brick bricks[BRICK_ROWS][BRICK_COLUMNS];
+    GameStats stats;
+    float speedLevels[MAX_TEST_BALLS]; // speed level each ball should end the step on
+    int extraBalls;                    // balls split off by broken bricks
+};
+
+std::mutex reportLock;
+std::atomic<int> reports(0);
+
+
+/**
+ * picks a speed level a ball could have reached, from none up to the fastest brick type
+ * @param random - random number stream for this case
+ * @return float - one of the brick types' speedAdjust values, or 0
+ */
+float randomSpeedLevel(Random &random)
+{
+    int type = int(random.next() % (BRICK_TYPES + 1));
+    return type < BRICK_TYPES ? BRICK_BEHAVIORS[type].speedAdjust : 0;
+}
+
+
+/**
+ * builds a random game state: fuzzed ball speed and frame time, paddle anywhere along
+ * the bottom and bricks in random hit states
+ * @param random - random number stream for this case
+ * @param test - test case to fill in
+ */
+void makeTestCase(Random &random, TestCase &test)
+{
+    test.walls.leftBlock = makeBlock(BOARD_LAYOUT.leftWall, WALL_COLOR);
+    test.walls.topBlock = makeBlock(BOARD_LAYOUT.topWall, WALL_COLOR);
+    test.walls.rightBlock = makeBlock(BOARD_LAYOUT.rightWall, WALL_COLOR);
+    test.walls.bottomBlock = makeBlock(BOARD_LAYOUT.bottomWall, WALL_COLOR);
+
+    test.paddle.block.left = random.uniform(-PADDLE_WIDTH, WINDOW_WIDTH);
+    test.paddle.block.top = WINDOW_HEIGHT - (2.0 * PADDLE_THICKNESS);
+    test.paddle.block.width = PADDLE_WIDTH;
+    test.paddle.block.height = PADDLE_THICKNESS;
+    test.paddle.velocityX = random.uniform(-0.5, 0.5);
+    test.paddle.velocityY = 0.0;
+
+    const BlockGeometry *pGeometry = &BOARD_LAYOUT.bricks[0][0];
+    Brick *pBrick = &test.bricks[0][0];
+    for (int brick = 0; brick < BRICK_ROWS * BRICK_COLUMNS; brick++)
+    {
+        pBrick->type = int(random.next() % BRICK_TYPES);
+        pBrick->block = makeBlock(*pGeometry, BRICK_BEHAVIORS[pBrick->type].color);
+        pBrick->hit = random.chance(0.25);
+        pBrick->hitsLeft = 1 + int(random.next() % BRICK_BEHAVIORS[pBrick->type].hits);
+        pGeometry++;
+        pBrick++;
+    }
+
+    // start half the balls among the bricks, the rest anywhere around the window
+    Ball &ball = test.ball;
+    ball.radius = BALL_RADIUS;
+    ball.color = BALL_COLOR;
+    ball.coordinateX = random.uniform(-3 * BALL_RADIUS, WINDOW_WIDTH + 3 * BALL_RADIUS);
+    if (random.chance(0.5))
+    {
+        ball.coordinateY = random.uniform(BRICKS_TOP - 4 * BALL_RADIUS, FIRST_BRICK + BRICK_HEIGHT + 4 * BALL_RADIUS);
+    }
+    else
+    {
+        ball.coordinateY = random.uniform(-3 * BALL_RADIUS, WINDOW_HEIGHT + 3 * BALL_RADIUS);
+    }
+    ball.velocityX = random.uniform(-1, 1);
+    ball.velocityY = random.uniform(-1, 1);
+
+    // start at a random speed level, so brick hits sometimes speed the ball up
+    ball.speedLevel = randomSpeedLevel(random);
+
+    // move the ball as update() does, mostly by normal frame times but sometimes by very long ones
+    float delta = random.uniform(0, 2 * FRAME_RATE);
+    if (random.chance(0.25))
+    {
+        delta = random.uniform(0, 2000);
+    }
+    else if (random.chance(0.01))
+    {
+        delta = random.uniform(0, 100000);
+    }
+    ball.coordinateX += ball.velocityX * delta;
+    ball.coordinateY += ball.velocityY * delta;
+    test.paddle.block.left += test.paddle.velocityX * delta;
+}
+
+
+/**
+ * records a divergence, printing the first few in full
+ * @param results - counts to add to
+ * @param kind - what diverged
+ * @param seed - run seed
+ * @param caseIndex - test case that diverged
+ * @param detail - what the reference and optimized code gave
+ */
+void report(Results &results, Divergence kind, std::uint64_t seed, long long caseIndex, const std::string &detail)
+{
+    results.counts[kind]++;
+    if (reports++ < MAX_REPORTS)
+    {
+        std::lock_guard<std::mutex> lock(reportLock);
+        std::cout << "divergence in " << DIVERGENCE_NAMES[kind] << " (--seed " << seed << " --case "
+                  << caseIndex << "): " << detail << "\n";
+    }
+}
+
+
+/**
+ * works out from BRICK_BEHAVIORS what breaking the claimed bricks should do
+ * @param bricks - bricks at the start of the step
+ * @param brickClaims - ball expected to claim each brick (MAX_BALLS for none)
+ * @param balls - balls at the start of the step
+ * @param count - number of balls
+ * @param expected - bricks, score, speed levels and extra balls to expect
+ */
+void expectHits(const Brick bricks[BRICK_ROWS][BRICK_COLUMNS], const int brickClaims[BRICK_ROWS * BRICK_COLUMNS],
+                const Ball balls[], int count, ExpectedHits &expected)
+{
+    std::copy(&bricks[0][0], &bricks[0][0] + BRICK_ROWS * BRICK_COLUMNS, &expected.bricks[0][0]);
+    expected.stats = {0, START_LIVES, BRICK_ROWS * BRICK_COLUMNS};
+    expected.extraBalls = 0;
+    for (int i = 0; i < count; i++)
+    {
+        expected.speedLevels[i] = balls[i].speedLevel;
+    }
+
+    for (int brick = 0; brick < BRICK_ROWS * BRICK_COLUMNS; brick++)
+    {
+        int ballIndex = brickClaims[brick];
+        if (ballIndex < MAX_BALLS)
+        {
+            Brick &hitBrick = (&expected.bricks[0][0])[brick];
+            const BrickBehavior &behavior = BRICK_BEHAVIORS[hitBrick.type];
+
+            // a brick breaks on its last hit, scoring its points and splitting off its extra balls
+            hitBrick.hit = hitBrick.hitsLeft == 1;
+            hitBrick.hitsLeft--;
+            if (hitBrick.hit)
+            {
+                expected.stats.score += behavior.points;
+                expected.stats.bricksLeft--;
+                expected.extraBalls += behavior.extraBalls;
+            }
+            expected.speedLevels[ballIndex] = std::max(expected.speedLevels[ballIndex], behavior.speedAdjust);
+        }
+    }
+}
+
+
+/**
+ * checks that a ball's speed was scaled up from one speed level to another
+ * @param ball - ball after its brick hits
+ * @param unscaled - the same ball with its speed before any brick hits
+ * @param fromLevel - speed level before the hits
+ * @param toLevel - speed level the hits should have reached
+ * @return bool - returns true if the speed and speed level match
+ */
+bool speedScaled(const Ball &ball, const Ball &unscaled, float fromLevel, float toLevel)
+{
+    double scale = (1 + toLevel * double(BALL_SPEEDUP)) / (1 + fromLevel * double(BALL_SPEEDUP));
+    double expectedX = unscaled.velocityX * scale;
+    double expectedY = unscaled.velocityY * scale;
+    double tolerance = 1e-5 * (std::fabs(expectedX) + std::fabs(expectedY)) + 1e-12;
+    return ball.speedLevel == toLevel &&
+           std::fabs(ball.velocityX - expectedX) <= tolerance && std::fabs(ball.velocityY - expectedY) <= tolerance;
+}
+
+
+/**
+ * compares bricks and score after a step with what BRICK_BEHAVIORS says they should be
+ * @param expected - expected bricks and score
+ * @param bricks - bricks after the step
+ * @param stats - score after the step
+ * @param label - which run is being checked
+ * @param seed - run seed
+ * @param caseIndex - test case being checked
+ * @param results - divergence counts to add to
+ */
+void checkHits(const ExpectedHits &expected, const Brick bricks[BRICK_ROWS][BRICK_COLUMNS], const GameStats &stats,
+               const std::string &label, std::uint64_t seed, long long caseIndex, Results &results)
+{
+    for (int brick = 0; brick < BRICK_ROWS * BRICK_COLUMNS; brick++)
+    {
+        const Brick &want = (&expected.bricks[0][0])[brick];
+        const Brick &got = (&bricks[0][0])[brick];
+        if (got.hit != want.hit || got.hitsLeft != want.hitsLeft)
+        {
+            report(results, BrickHit, seed, caseIndex, label + " brick " + std::to_string(brick) + ": hit " +
+                   std::to_string(want.hit) + "/" + std::to_string(want.hitsLeft) + " left vs " +
+                   std::to_string(got.hit) + "/" + std::to_string(got.hitsLeft) + " left");
+        }
+    }
+    if (stats.score != expected.stats.score || stats.bricksLeft != expected.stats.bricksLeft)
+    {
+        report(results, Score, seed, caseIndex, label + " score " + std::to_string(expected.stats.score) + " vs " +
+               std::to_string(stats.score) + ", bricks left " + std::to_string(expected.stats.bricksLeft) +
+               " vs " + std::to_string(stats.bricksLeft));
+    }
+}
+
+
+/**
+ * breaks the claimed bricks, as doCollisionChecks() does after its ball pass
+ * @param balls - balls that made the claims
+ * @param bricks - bricks to break
+ * @param brickClaims - lowest ball to hit each brick
+ * @param stats - score to update
+ */
+void breakClaimedBricks(BallSet &balls, Brick bricks[BRICK_ROWS][BRICK_COLUMNS],
+                        int brickClaims[BRICK_ROWS * BRICK_COLUMNS], GameStats &stats)
+{
+    Brick *pBrick = &bricks[0][0];
+    for (int brick = 0; brick < BRICK_ROWS * BRICK_COLUMNS; brick++)
+    {
+        if (brickClaims[brick] < MAX_BALLS)
+        {
+            hitBrick(pBrick, balls, brickClaims[brick], stats);
+        }
+        pBrick++;
+    }
+}
+
+
+/**
+ * checks the multi-ball brick claim rule: several balls aimed at one brick must each move as they
+ * would alone against the reference, the lowest numbered ball hitting a brick must claim it, and
+ * passing the balls in shuffled order must give the same claims and the same bricks and score
+ * @param random - random number stream for this case
+ * @param test - game state to start from
+ * @param seed - run seed
+ * @param caseIndex - test case to run
+ * @param results - divergence counts to add to
+ */
+void runMultiBallCase(Random &random, TestCase &test, std::uint64_t seed, long long caseIndex, Results &results)
+{
+    // aim every ball at one brick so they are likely to hit it in the same step
+    int count = 2 + int(random.next() % (MAX_TEST_BALLS - 1));
+    const Block &target = (&test.bricks[0][0])[random.next() % (BRICK_ROWS * BRICK_COLUMNS)].block;
+    float reachX = target.width / 2 + BALL_RADIUS;
+    float reachY = target.height / 2 + BALL_RADIUS;
+
+    BallSet start;
+    start.count = count;
+    start.launchCount = count;
+    for (int i = 0; i < count; i++)
+    {
+        Ball &ball = start.balls[i];
+        ball = test.ball;
+        ball.coordinateX = target.left + target.width / 2 + random.uniform(-reachX, reachX);
+        ball.coordinateY = target.top + target.height / 2 + random.uniform(-reachY, reachY);
+        ball.velocityX = random.uniform(-1, 1);
+        ball.velocityY = random.uniform(-1, 1);
+        ball.speedLevel = randomSpeedLevel(random);
+    }
+
+    // a shuffled processing order (Fisher-Yates)
+    int order[MAX_TEST_BALLS];
+    for (int i = 0; i < count; i++)
+    {
+        order[i] = i;
+    }
+    for (int i = count - 1; i > 0; i--)
+    {
+        std::swap(order[i], order[random.next() % (i + 1)]);
+    }
+
+    // reference: each ball alone against the bricks as they were at the start of the step
+    //-----------------------------------------
+    int expectedClaims[BRICK_ROWS * BRICK_COLUMNS];
+    std::fill(expectedClaims, expectedClaims + BRICK_ROWS * BRICK_COLUMNS, MAX_BALLS);
+    Ball referenceBalls[MAX_TEST_BALLS];
+    bool referenceLost[MAX_TEST_BALLS];
+    for (int i = 0; i < count; i++)
+    {
+        referenceBalls[i] = start.balls[i];
+        MovingBlock paddle = test.paddle;
+        Brick bricks[BRICK_ROWS][BRICK_COLUMNS];
+        std::copy(&test.bricks[0][0], &test.bricks[0][0] + BRICK_ROWS * BRICK_COLUMNS, &bricks[0][0]);
+        referenceLost[i] = reference::doCollisionChecks(referenceBalls[i], paddle, test.walls, bricks);
+
+        for (int brick = 0; brick < BRICK_ROWS * BRICK_COLUMNS; brick++)
+        {
+            if (!(&test.bricks[0][0])[brick].hit && (&bricks[0][0])[brick].hit)
+            {
+                expectedClaims[brick] = std::min(expectedClaims[brick], i);
+            }
+        }
+    }
+
+    // optimized: the ball pass in order, then in shuffled order
+    //-----------------------------------------
+    BallSet inOrder = start;
+    BallSet shuffled = start;
+    bool lostInOrder[MAX_TEST_BALLS];
+    bool lostShuffled[MAX_TEST_BALLS];
+    int claimsInOrder[BRICK_ROWS * BRICK_COLUMNS];
+    int claimsShuffled[BRICK_ROWS * BRICK_COLUMNS];
+    std::fill(claimsInOrder, claimsInOrder + BRICK_ROWS * BRICK_COLUMNS, MAX_BALLS);
+    std::fill(claimsShuffled, claimsShuffled + BRICK_ROWS * BRICK_COLUMNS, MAX_BALLS);
+    for (int i = 0; i < count; i++)
+    {
+        lostInOrder[i] = collideBall(&inOrder.balls[i], test.paddle, test.walls, test.bricks, i, claimsInOrder);
+        int ballIndex = order[i];
+        lostShuffled[ballIndex] = collideBall(&shuffled.balls[ballIndex], test.paddle, test.walls, test.bricks,
+                                              ballIndex, claimsShuffled);
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        const Ball &expected = referenceBalls[i];
+        const Ball &ball = inOrder.balls[i];
+        const Ball &other = shuffled.balls[i];
+        if (ball.coordinateX != expected.coordinateX || ball.coordinateY != expected.coordinateY ||
+            ball.velocityX != expected.velocityX || ball.velocityY != expected.velocityY ||
+            lostInOrder[i] != referenceLost[i])
+        {
+            report(results, Position, seed, caseIndex, "ball " + std::to_string(i) + " of " +
+                   std::to_string(count) + " moved differently from the reference");
+        }
+        if (other.coordinateX != ball.coordinateX || other.coordinateY != ball.coordinateY ||
+            other.velocityX != ball.velocityX || other.velocityY != ball.velocityY ||
+            lostShuffled[i] != lostInOrder[i])
+        {
+            report(results, ProcessOrder, seed, caseIndex, "ball " + std::to_string(i) + " of " +
+                   std::to_string(count) + " moved differently in shuffled order");
+        }
+    }
+
+    for (int brick = 0; brick < BRICK_ROWS * BRICK_COLUMNS; brick++)
+    {
+        if (claimsInOrder[brick] != expectedClaims[brick])
+        {
+            report(results, BrickClaim, seed, caseIndex, "brick " + std::to_string(brick) + ": ball " +
+                   std::to_string(expectedClaims[brick]) + " vs ball " + std::to_string(claimsInOrder[brick]));
+        }
+        if (claimsShuffled[brick] != claimsInOrder[brick])
+        {
+            report(results, ProcessOrder, seed, caseIndex, "brick " + std::to_string(brick) + " claimed by ball " +
+                   std::to_string(claimsInOrder[brick]) + " vs ball " + std::to_string(claimsShuffled[brick]));
+        }
+    }
+
+    // break the claimed bricks both ways, and through the whole doCollisionChecks() step
+    //-----------------------------------------
+    Brick bricksInOrder[BRICK_ROWS][BRICK_COLUMNS];
+    Brick bricksShuffled[BRICK_ROWS][BRICK_COLUMNS];
+    Brick bricksStep[BRICK_ROWS][BRICK_COLUMNS];
+    std::copy(&test.bricks[0][0], &test.bricks[0][0] + BRICK_ROWS * BRICK_COLUMNS, &bricksInOrder[0][0]);
+    std::copy(&test.bricks[0][0], &test.bricks[0][0] + BRICK_ROWS * BRICK_COLUMNS, &bricksShuffled[0][0]);
+    std::copy(&test.bricks[0][0], &test.bricks[0][0] + BRICK_ROWS * BRICK_COLUMNS, &bricksStep[0][0]);
+    GameStats statsInOrder = {0, START_LIVES, BRICK_ROWS * BRICK_COLUMNS};
+    GameStats statsShuffled = statsInOrder;
+    GameStats statsStep = statsInOrder;
+
+    breakClaimedBricks(inOrder, bricksInOrder, claimsInOrder, statsInOrder);
+    breakClaimedBricks(shuffled, bricksShuffled, claimsShuffled, statsShuffled);
+    BallSet step = start;
+    MovingBlock paddle = test.paddle;
+    doCollisionChecks(step, paddle, test.walls, bricksStep, statsStep);
+
+    // the in-order run against BRICK_BEHAVIORS and the reference claims
+    ExpectedHits expected;
+    expectHits(test.bricks, expectedClaims, start.balls, count, expected);
+    checkHits(expected, bricksInOrder, statsInOrder, "multi-ball", seed, caseIndex, results);
+    if (inOrder.count != count + expected.extraBalls)
+    {
+        report(results, BallCount, seed, caseIndex, std::to_string(count + expected.extraBalls) + " balls vs " +
+               std::to_string(inOrder.count));
+    }
+    for (int i = 0; i < count; i++)
+    {
+        if (!speedScaled(inOrder.balls[i], referenceBalls[i], start.balls[i].speedLevel, expected.speedLevels[i]))
+        {
+            report(results, SpeedUp, seed, caseIndex, "ball " + std::to_string(i) + " speed level " +
+                   std::to_string(expected.speedLevels[i]) + " vs " + std::to_string(inOrder.balls[i].speedLevel) +
+                   ", x velocity " + std::to_string(referenceBalls[i].velocityX) + " before speed-up vs " +
+                   std::to_string(inOrder.balls[i].velocityX) + " after");
+        }
+    }
+
+    if (statsShuffled.score != statsInOrder.score || statsShuffled.bricksLeft != statsInOrder.bricksLeft ||
+        inOrder.count != shuffled.count)
+    {
+        report(results, ProcessOrder, seed, caseIndex, "score " + std::to_string(statsInOrder.score) + " vs " +
+               std::to_string(statsShuffled.score));
+    }
+    if (statsStep.score != statsInOrder.score || statsStep.bricksLeft != statsInOrder.bricksLeft)
+    {
+        report(results, BrickHit, seed, caseIndex, "whole step scored " + std::to_string(statsStep.score) +
+               " vs " + std::to_string(statsInOrder.score));
+    }
+    for (int brick = 0; brick < BRICK_ROWS * BRICK_COLUMNS; brick++)
+    {
+        const Brick &inOrderBrick = (&bricksInOrder[0][0])[brick];
+        const Brick &shuffledBrick = (&bricksShuffled[0][0])[brick];
+        const Brick &stepBrick = (&bricksStep[0][0])[brick];
+        if (shuffledBrick.hit != inOrderBrick.hit || shuffledBrick.hitsLeft != inOrderBrick.hitsLeft)
+        {
+            report(results, ProcessOrder, seed, caseIndex, "brick " + std::to_string(brick) + " broke differently");
+        }
+        if (stepBrick.hit != inOrderBrick.hit || stepBrick.hitsLeft != inOrderBrick.hitsLeft)
+        {
+            report(results, BrickHit, seed, caseIndex, "brick " + std::to_string(brick) +
+                   " broke differently in the whole step");
+        }
+    }
+}
+
+
+/**
+ * runs one test case through the reference and optimized code and compares the results
+ * @param seed - run seed
+ * @param caseIndex - test case to run
+ * @param results - divergence counts to add to
+ */
+void runTestCase(std::uint64_t seed, long long caseIndex, Results &results)
+{
+    Random random = {seed ^ (std::uint64_t(caseIndex) * 0xD1B54A32D192ED03ull)};
+    TestCase test;
+    makeTestCase(random, test);
+
+    // reference: one ball against every brick
+    //-----------------------------------------
+    Ball referenceBall = test.ball;
+    MovingBlock referencePaddle = test.paddle;
+    Brick referenceBricks[BRICK_ROWS][BRICK_COLUMNS];
+    std::copy(&test.bricks[0][0], &test.bricks[0][0] + BRICK_ROWS * BRICK_COLUMNS, &referenceBricks[0][0]);
+    bool referenceLost = reference::doCollisionChecks(referenceBall, referencePaddle, test.walls, referenceBricks);
+
+    // optimized: the ball pass through the brick broadphase
+    //-----------------------------------------
+    int brickClaims[BRICK_ROWS * BRICK_COLUMNS];
+    std::fill(brickClaims, brickClaims + BRICK_ROWS * BRICK_COLUMNS, MAX_BALLS);
+    Ball ball = test.ball;
+    MovingBlock paddle = test.paddle;
+    bool lost = collideBall(&ball, paddle, test.walls, test.bricks, 0, brickClaims);
+
+    if (lost != referenceLost)
+    {
+        report(results, BallLost, seed, caseIndex, std::to_string(referenceLost) + " vs " + std::to_string(lost));
+    }
+    if (std::signbit(ball.velocityX) != std::signbit(referenceBall.velocityX) ||
+        std::signbit(ball.velocityY) != std::signbit(referenceBall.velocityY))
+    {
+        report(results, Bounce, seed, caseIndex, "velocity signs differ");
+    }
+    if (ball.coordinateX != referenceBall.coordinateX || ball.coordinateY != referenceBall.coordinateY ||
+        ball.velocityX != referenceBall.velocityX || ball.velocityY != referenceBall.velocityY)
+    {
+        report(results, Position, seed, caseIndex,
+               "(" + std::to_string(referenceBall.coordinateX) + ", " + std::to_string(referenceBall.coordinateY) +
+               ") vs (" + std::to_string(ball.coordinateX) + ", " + std::to_string(ball.coordinateY) + ")");
+    }
+
+    // optimized: the whole step, which breaks claimed bricks and keeps the paddle inside the walls
+    //-----------------------------------------
+    BallSet balls;
+    balls.balls[0] = test.ball;
+    balls.count = 1;
+    balls.launchCount = 1;
+    GameStats stats = {0, START_LIVES, BRICK_ROWS * BRICK_COLUMNS};
+    Brick bricks[BRICK_ROWS][BRICK_COLUMNS];
+    std::copy(&test.bricks[0][0], &test.bricks[0][0] + BRICK_ROWS * BRICK_COLUMNS, &bricks[0][0]);
+    MovingBlock stepPaddle = test.paddle;
+    bool allLost = doCollisionChecks(balls, stepPaddle, test.walls, bricks, stats);
+
+    if (stepPaddle.block.left != referencePaddle.block.left || stepPaddle.velocityX != referencePaddle.velocityX)
+    {
+        report(results, Paddle, seed, caseIndex, std::to_string(referencePaddle.block.left) + " vs " +
+               std::to_string(stepPaddle.block.left));
+    }
+
+    // the bricks the reference hit must be the ones claimed
+    int expectedClaims[BRICK_ROWS * BRICK_COLUMNS];
+    for (int brick = 0; brick < BRICK_ROWS * BRICK_COLUMNS; brick++)
+    {
+        const Brick &before = (&test.bricks[0][0])[brick];
+        const Brick &after = (&bricks[0][0])[brick];
+        bool referenceHit = !before.hit && (&referenceBricks[0][0])[brick].hit;
+        expectedClaims[brick] = referenceHit ? 0 : MAX_BALLS;
+        if (referenceHit != (brickClaims[brick] == 0))
+        {
+            report(results, BrickClaim, seed, caseIndex, "brick " + std::to_string(brick) + ": " +
+                   std::to_string(referenceHit) + " vs " + std::to_string(brickClaims[brick] == 0));
+        }
+
+        // one-hit bricks break exactly when the reference breaks them
+        if (BRICK_BEHAVIORS[before.type].hits == 1 && after.hit != (&referenceBricks[0][0])[brick].hit)
+        {
+            report(results, BrickHit, seed, caseIndex, "one-hit brick " + std::to_string(brick) + ": " +
+                   std::to_string((&referenceBricks[0][0])[brick].hit) + " vs " + std::to_string(after.hit));
+        }
+    }
+
+    // bricks, score, ball and ball count against BRICK_BEHAVIORS and the reference
+    ExpectedHits expected;
+    expectHits(test.bricks, expectedClaims, &test.ball, 1, expected);
+    checkHits(expected, bricks, stats, "whole step", seed, caseIndex, results);
+
+    int expectedCount = (referenceLost ? 0 : 1) + expected.extraBalls;
+    if (balls.count != expectedCount || allLost != (expectedCount == 0))
+    {
+        report(results, BallCount, seed, caseIndex, std::to_string(expectedCount) + " balls vs " +
+               std::to_string(balls.count));
+    }
+    else if (!referenceLost)
+    {
+        const Ball &stepBall = balls.balls[0];
+        if (stepBall.coordinateX != referenceBall.coordinateX || stepBall.coordinateY != referenceBall.coordinateY)
+        {
+            report(results, Position, seed, caseIndex, "whole step moved the ball differently");
+        }
+        if (std::signbit(stepBall.velocityX) != std::signbit(referenceBall.velocityX) ||
+            std::signbit(stepBall.velocityY) != std::signbit(referenceBall.velocityY))
+        {
+            report(results, Bounce, seed, caseIndex, "whole step velocity signs differ");
+        }
+        if (!speedScaled(stepBall, referenceBall, test.ball.speedLevel, expected.speedLevels[0]))
+        {
+            report(results, SpeedUp, seed, caseIndex, "whole step speed level " +
+                   std::to_string(expected.speedLevels[0]) + " vs " + std::to_string(stepBall.speedLevel) +
+                   ", x velocity " + std::to_string(referenceBall.velocityX) + " before speed-up vs " +
+                   std::to_string(stepBall.velocityX) + " after");
+        }
+    }
+
+    runMultiBallCase(random, test, seed, caseIndex, results);
+}
+
+
+/**
+ * runs random game states through the original and optimized collision code on every core
+ * @param argc - number of command line arguments
+ * @param argv - --cases N, --seed S, --threads T, or --case I to rerun one case
+ * @return OS status message (0=no divergence)
+ */
+int main(int argc, char *argv[]) {
+
+    long long cases = 1000000;
+    std::uint64_t seed = 2024;
+    long long onlyCase = -1;
+    int threadCount = int(std::thread::hardware_concurrency());
+
+    for (int arg = 1; arg + 1 < argc; arg++)
+    {
+        if (strcmp(argv[arg], "--cases") == 0)
+            cases = atoll(argv[++arg]);
+        else if (strcmp(argv[arg], "--seed") == 0)
+            seed = strtoull(argv[++arg], nullptr, 10);
+        else if (strcmp(argv[arg], "--threads") == 0)
+            threadCount = atoi(argv[++arg]);
+        else if (strcmp(argv[arg], "--case") == 0)
+            onlyCase = atoll(argv[++arg]);
+    }
+    threadCount = std::max(threadCount, 1);
+
+    std::vector<Results> results(threadCount, Results{});
+    if (onlyCase >= 0)
+    {
+        threadCount = 1;
+        runTestCase(seed, onlyCase, results[0]);
+        cases = 1;
+    }
+    else
+    {
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < threadCount; thread++)
+        {
+            threads.emplace_back([=, &results]() {
+                for (long long caseIndex = thread; caseIndex < cases; caseIndex += threadCount)
+                {
+                    runTestCase(seed, caseIndex, results[thread]);
+                }
+            });
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    long long total = 0;
+    std::cout << "\nChecked " << cases << " cases on " << threadCount << " threads (seed " << seed << ")\n";
+    for (int kind = 0; kind < DIVERGENCES; kind++)
+    {
+        long long count = 0;
+        for (const Results &result : results)
+        {
+            count += result.counts[kind];
+        }
+        std::cout << "  " << DIVERGENCE_NAMES[kind] << ": " << count << " divergences\n";
+        total += count;
+    }
+
+    return total == 0 ? 0 : 1;
+}